@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------
+// Model (M)
+// -------------------------
+
+/// RawSample: amostra bruta dos sensores, exatamente como lida do hardware.
+/// É o registro gravado no trace (12 bytes, little-endian, sem padding).
+struct RawSample {
+    uint32_t timestamp;      // millis() no momento da leitura
+    uint16_t adc;            // MQ-6, leitura direta do ADC (0–4095)
+    int16_t  temperatureDC;  // BMP180, décimos de °C
+    int32_t  pressurePa;     // BMP180, Pa
+};
+static_assert(sizeof(RawSample) == 12, "RawSample deve ter 12 bytes");
+
+struct SensorReading {
+    float gasPPM;
+    float temperature;
+    float pressure;
+    uint32_t timestamp;
+};
+
+/// Converte a amostra bruta em leitura física (PPM, °C, hPa).
+inline SensorReading convertSample(const RawSample& s) {
+    SensorReading r;
+
+    // 1) Leitura direta do ADC (0–4095) → tensão medida (0–3.3 V)
+    float measuredV = s.adc * (3.3f / 4095.0f);
+
+    // 2) Reconverte para tensão real no sensor (divisor 1:2)
+    float sensorV = measuredV * 2.0f;  // agora entre 0 e ~2.5 V (sensor até 5 V)
+
+    // 3) Mapeamento linear de [0…5 V] → [200…10000 PPM]
+    //    PPM = (sensorV / 5.0) * (10000 – 200) + 200
+    float ppm = (sensorV / 5.0f) *  (10000.0f - 200.0f) + 200.0f;
+
+    // 4) Garante limites
+    if (ppm < 200.0f)   ppm = 200.0f;
+    if (ppm > 10000.0f) ppm = 10000.0f;
+
+    r.gasPPM      = ppm;
+    r.temperature = s.temperatureDC / 10.0f;
+    r.pressure    = s.pressurePa / 100.0f;
+    r.timestamp   = s.timestamp;
+    return r;
+}
+
+// -------------------------
+// Abstraction (A)
+// -------------------------
+class ISensorReader {
+public:
+    virtual ~ISensorReader() = default;
+    virtual RawSample readRaw() = 0;
+    SensorReading read() { return convertSample(readRaw()); }
+};
+
+class IDisplay {
+public:
+    virtual ~IDisplay() = default;
+    virtual void update(const SensorReading& data) = 0;
+};
+
+class IMqttPublisher {
+public:
+    virtual ~IMqttPublisher() = default;
+    virtual void begin(const char* server, uint16_t port) = 0;
+    virtual bool reconnect() = 0;
+    virtual void loop() = 0;
+    virtual void publish(const SensorReading& data) = 0;
+    virtual void publishCommand(const char* topic, const char* msg) = 0;
+};
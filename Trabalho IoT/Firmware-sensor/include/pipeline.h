@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdio.h>
+#include "model.h"
+
+// -------------------------
+// Logic (L) — independente de hardware
+// Compartilhada entre o firmware e o replayer de traces (src/replay).
+// -------------------------
+
+inline void formatReadingTopic(char* buf, size_t len, const char* mac) {
+    snprintf(buf, len, "spvg/casa/cozinha/gas/leitura/%s", mac);
+}
+
+inline void formatReadingPayload(char* buf, size_t len, const SensorReading& data) {
+    snprintf(buf, len,
+             "{\"gas\":%.1f,\"temp\":%.1f,\"press\":%.1f}",
+             data.gasPPM, data.temperature, data.pressure);
+}
+
+inline void formatCommandTopic(char* buf, size_t len, const char* mac) {
+    snprintf(buf, len, "spvg/casa/cozinha/gas/comando/%s", mac);
+}
+
+/// Comando de segurança da válvula para uma leitura.
+inline const char* safetyCommand(float gasPPM, float thresholdPPM) {
+    return (gasPPM > thresholdPPM) ? "{\"act\":\"CLOSE\"}"
+                                   : "{\"act\":\"OPEN\"}";
+}
+
+/// Publica a leitura e o comando de segurança correspondente.
+inline void publishReading(IMqttPublisher& publisher, const SensorReading& data,
+                           const char* mac, float thresholdPPM) {
+    char cmdTopic[80];
+
+    // Publica leitura
+    publisher.publish(data);
+
+    // Publica comando de segurança
+    formatCommandTopic(cmdTopic, sizeof(cmdTopic), mac);
+    publisher.publishCommand(cmdTopic, safetyCommand(data.gasPPM, thresholdPPM));
+}
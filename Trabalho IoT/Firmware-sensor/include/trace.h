@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdio.h>
+#include "model.h"
+
+// -------------------------
+// Trace de amostras brutas
+// -------------------------
+//
+// Transporte (firmware → host): uma linha de texto por amostra na Serial,
+// intercalada com o log normal:
+//
+//     #TR,<timestamp>,<adc>,<temperatureDC>,<pressurePa>
+//
+// Armazenamento (corpus): arquivo binário compacto, TraceHeader seguido de
+// N registros RawSample (12 bytes cada, little-endian).
+
+static const char     TRACE_MAGIC[4]   = {'S', 'P', 'V', 'T'};
+static const uint16_t TRACE_VERSION    = 1;
+static const char     TRACE_LINE_TAG[] = "#TR,";
+
+struct TraceHeader {
+    char     magic[4];
+    uint16_t version;
+    uint16_t sampleSize;  // sizeof(RawSample) na gravação
+};
+static_assert(sizeof(TraceHeader) == 8, "TraceHeader deve ter 8 bytes");
+
+/// Formata a linha de trace (sem '\n'). Retorna o tamanho escrito.
+inline int formatTraceLine(char* buf, size_t len, const RawSample& s) {
+    return snprintf(buf, len, "%s%lu,%u,%d,%ld", TRACE_LINE_TAG,
+                    (unsigned long)s.timestamp, (unsigned)s.adc,
+                    (int)s.temperatureDC, (long)s.pressurePa);
+}
+
+/// Interpreta uma linha de trace; ignora linhas que não começam com a tag.
+inline bool parseTraceLine(const char* line, RawSample& s) {
+    unsigned long ts;
+    unsigned adc;
+    int temp;
+    long press;
+    const char* p = line;
+    for (const char* t = TRACE_LINE_TAG; *t; ++t, ++p) {
+        if (*p != *t) return false;
+    }
+    if (sscanf(p, "%lu,%u,%d,%ld", &ts, &adc, &temp, &press) != 4) return false;
+    s.timestamp     = (uint32_t)ts;
+    s.adc           = (uint16_t)adc;
+    s.temperatureDC = (int16_t)temp;
+    s.pressurePa    = (int32_t)press;
+    return true;
+}
@@ -8,41 +8,9 @@
 #include <freertos/queue.h>
 #include <freertos/semphr.h>
 #include "config.h"
-
-// -------------------------
-// Model (M)
-// -------------------------
-struct SensorReading {
-    float gasPPM;
-    float temperature;
-    float pressure;
-    uint32_t timestamp;
-};
-
-// -------------------------
-// Abstraction (A)
-// -------------------------
-class ISensorReader {
-public:
-    virtual ~ISensorReader() = default;
-    virtual SensorReading read() = 0;
-};
-
-class IDisplay {
-public:
-    virtual ~IDisplay() = default;
-    virtual void update(const SensorReading& data) = 0;
-};
-
-class IMqttPublisher {
-public:
-    virtual ~IMqttPublisher() = default;
-    virtual void begin(const char* server, uint16_t port) = 0;
-    virtual bool reconnect() = 0;                     
-    virtual void loop() = 0;
-    virtual void publish(const SensorReading& data) = 0;
-    virtual void publishCommand(const char* topic, const char* msg) = 0;
-};
+#include "model.h"
+#include "pipeline.h"
+#include "trace.h"
 
 // -------------------------
 // Service (S)
@@ -56,35 +24,21 @@ public:
         bmp.begin();
     }
 
-    SensorReading read() override {
-        SensorReading r;
-
-        // 1) Leitura direta do ADC (0–4095) → tensão medida (0–3.3 V)
-        int raw = analogRead(_pin);
-        float measuredV = raw * (3.3f / 4095.0f);
-
-        // 2) Reconverte para tensão real no sensor (divisor 1:2)
-        float sensorV = measuredV * 2.0f;  // agora entre 0 e ~2.5 V (sensor até 5 V)
+    RawSample readRaw() override {
+        RawSample s = {};
 
-        // 3) Mapeamento linear de [0…5 V] → [200…10000 PPM]
-        //    PPM = (sensorV / 5.0) * (10000 – 200) + 200
-        float ppm = (sensorV / 5.0f) *  (10000.0f - 200.0f) + 200.0f;
+        // 1) Leitura direta do ADC (0–4095); conversão em convertSample()
+        s.adc = analogRead(_pin);
 
-        // 4) Garante limites
-        if (ppm < 200.0f)   ppm = 200.0f;
-        if (ppm > 10000.0f) ppm = 10000.0f;
-
-        r.gasPPM = ppm;
-
-        // 5) Leitura BMP180
+        // 2) Leitura BMP180
         if (xSemaphoreTake(_i2cSem, portMAX_DELAY) == pdTRUE) {
-            r.temperature = bmp.readTemperature();
-            r.pressure    = bmp.readPressure() / 100.0f;
+            s.temperatureDC = lroundf(bmp.readTemperature() * 10.0f);
+            s.pressurePa    = bmp.readPressure();
             xSemaphoreGive(_i2cSem);
         }
 
-        r.timestamp = millis();
-        return r;
+        s.timestamp = millis();
+        return s;
     }
 
 private:
@@ -93,6 +47,26 @@ private:
     SemaphoreHandle_t _i2cSem;
 };
 
+#ifdef TRACE_RECORD
+/// TraceRecorder: repassa as amostras do leitor real e as grava na Serial
+/// no formato de trace (ver trace.h) para replay no host.
+class TraceRecorder : public ISensorReader {
+public:
+    TraceRecorder(ISensorReader& inner) : _inner(inner) {}
+
+    RawSample readRaw() override {
+        char line[64];
+        RawSample s = _inner.readRaw();
+        formatTraceLine(line, sizeof(line), s);
+        Serial.println(line);
+        return s;
+    }
+
+private:
+    ISensorReader& _inner;
+};
+#endif
+
 /// OledDisplay: atualiza display SSD1306 via I2C
 class OledDisplay : public IDisplay {
 public:
@@ -155,12 +129,8 @@ public:
 
     void publish(const SensorReading& data) override {
         char topic[80], payload[128];
-        snprintf(topic, sizeof(topic),
-                 "spvg/casa/cozinha/gas/leitura/%s",
-                 DEVICE_MAC);
-        snprintf(payload, sizeof(payload),
-                 "{\"gas\":%.1f,\"temp\":%.1f,\"press\":%.1f}",
-                 data.gasPPM, data.temperature, data.pressure);
+        formatReadingTopic(topic, sizeof(topic), DEVICE_MAC);
+        formatReadingPayload(payload, sizeof(payload), data);
         _mqtt.publish(topic, payload);
     }
 
@@ -240,7 +210,6 @@ void TaskDisplay(void* pvParameters) {
 void TaskMQTTPublish(void* pvParameters) {
     auto logic = static_cast<SystemLogic*>(pvParameters);
     SensorReading data;
-    char cmdTopic[80];
 
     for (;;) {
         // 1) Aguarda nova leitura
@@ -257,17 +226,8 @@ void TaskMQTTPublish(void* pvParameters) {
                 vTaskDelay(pdMS_TO_TICKS(2000));
             }
 
-            // 4) Publica leitura
-            logic->publisher->publish(data);
-
-            // 5) Publica comando de segurança
-            snprintf(cmdTopic, sizeof(cmdTopic),
-                     "spvg/casa/cozinha/gas/comando/%s",
-                     DEVICE_MAC);
-            const char* cmd = (data.gasPPM > GAS_LEAK_THRESHOLD_PPM)
-                              ? "{\"act\":\"CLOSE\"}"
-                              : "{\"act\":\"OPEN\"}";
-            logic->publisher->publishCommand(cmdTopic, cmd);
+            // 4) Publica leitura e 5) comando de segurança (ver pipeline.h)
+            publishReading(*logic->publisher, data, DEVICE_MAC, GAS_LEAK_THRESHOLD_PPM);
 
             // 6) Mantém o keep-alive e libera o semáforo pra próxima publicação
             logic->publisher->loop();
@@ -298,6 +258,9 @@ void setup() {
     // Instancia serviços
     static SensorReader sensor(MQ6_PIN, logicPtr->getI2CSem());
     static OledDisplay  oled(logicPtr->getI2CSem());
+#ifdef TRACE_RECORD
+    static TraceRecorder recorder(sensor);
+#endif
 
     // Cria um WiFiClient nomeado e passa-o ao construtor
     static WiFiClient    espClient;
@@ -307,7 +270,11 @@ void setup() {
     mqtt.begin(MQTT_SERVER, MQTT_PORT);
 
     // Atualiza ponteiros de reader/display/mqtt
+#ifdef TRACE_RECORD
+    logicPtr->reader    = &recorder;
+#else
     logicPtr->reader    = &sensor;
+#endif
     logicPtr->display   = &oled;
     logicPtr->publisher = &mqtt;
 
@@ -0,0 +1,246 @@
+// Replayer de traces do módulo sensor (host, env:native).
+//
+// Reexecuta amostras brutas gravadas pelo firmware (build com -D TRACE_RECORD)
+// pela mesma lógica do firmware: convertSample() → limiar → publishReading(),
+// sem atrasos, e confere o resultado contra o manifesto do corpus.
+//
+//   replay import <monitor.log> <saida.trace>   converte o log da Serial
+//   replay bench  <manifest.csv> [iteracoes]    roda o corpus como benchmark
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "model.h"
+#include "pipeline.h"
+#include "trace.h"
+
+static const char* REPLAY_MAC = "REPLAY";
+
+// -------------------------
+// Trace (arquivo binário)
+// -------------------------
+static bool loadTrace(const std::string& path, std::vector<RawSample>& out) {
+    std::ifstream in(path, std::ios::binary);
+    TraceHeader h;
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof(h))) return false;
+    if (memcmp(h.magic, TRACE_MAGIC, sizeof(h.magic)) != 0 ||
+        h.version != TRACE_VERSION || h.sampleSize != sizeof(RawSample)) {
+        return false;
+    }
+    RawSample s;
+    while (in.read(reinterpret_cast<char*>(&s), sizeof(s))) out.push_back(s);
+    return true;
+}
+
+static bool saveTrace(const std::string& path, const std::vector<RawSample>& samples) {
+    std::ofstream out(path, std::ios::binary);
+    TraceHeader h;
+    memcpy(h.magic, TRACE_MAGIC, sizeof(h.magic));
+    h.version    = TRACE_VERSION;
+    h.sampleSize = sizeof(RawSample);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(samples.data()),
+              samples.size() * sizeof(RawSample));
+    return static_cast<bool>(out);
+}
+
+// -------------------------
+// Service (S) — substitutos do hardware
+// -------------------------
+
+/// ReplayReader: entrega as amostras do trace no lugar do SensorReader.
+class ReplayReader : public ISensorReader {
+public:
+    ReplayReader(const std::vector<RawSample>& samples) : _samples(samples), _next(0) {}
+
+    bool done() const { return _next >= _samples.size(); }
+    RawSample readRaw() override { return _samples[_next++]; }
+
+private:
+    const std::vector<RawSample>& _samples;
+    size_t _next;
+};
+
+/// CapturePublisher: registra as mensagens MQTT em vez de enviá-las.
+/// O conteúdo é resumido por contagem e hash FNV-1a de tópico + payload.
+class CapturePublisher : public IMqttPublisher {
+public:
+    CapturePublisher() : messages(0), digest(1469598103934665603ULL), closed(false) {}
+
+    void begin(const char*, uint16_t) override {}
+    bool reconnect() override { return true; }
+    void loop() override {}
+
+    void publish(const SensorReading& data) override {
+        char topic[80], payload[128];
+        formatReadingTopic(topic, sizeof(topic), REPLAY_MAC);
+        formatReadingPayload(payload, sizeof(payload), data);
+        record(topic, payload);
+    }
+
+    void publishCommand(const char* topic, const char* msg) override {
+        closed = strstr(msg, "CLOSE") != nullptr;
+        record(topic, msg);
+    }
+
+    uint32_t messages;
+    uint64_t digest;
+    bool     closed;  // último comando enviado foi CLOSE
+
+private:
+    void record(const char* topic, const char* payload) {
+        ++messages;
+        hash(topic);
+        hash(payload);
+    }
+
+    void hash(const char* s) {
+        do {
+            digest ^= static_cast<unsigned char>(*s);
+            digest *= 1099511628211ULL;
+        } while (*s++);
+    }
+};
+
+// -------------------------
+// Logic (L)
+// -------------------------
+struct ReplayResult {
+    uint32_t messages;
+    uint64_t digest;
+    long     detectMs;        // latência de detecção; -1 se não detectou
+    int      falsePositives;  // alarmes (OPEN → CLOSE) antes do início do vazamento
+};
+
+/// Reexecuta o trace. leakOnsetMs é relativo à primeira amostra (-1: sem vazamento).
+static ReplayResult replay(const std::vector<RawSample>& samples,
+                           float thresholdPPM, long leakOnsetMs) {
+    ReplayReader     reader(samples);
+    CapturePublisher publisher;
+    ReplayResult     res = {0, 0, -1, 0};
+    uint32_t         t0 = samples.empty() ? 0 : samples.front().timestamp;
+    bool             wasClosed = false;
+
+    while (!reader.done()) {
+        SensorReading data = reader.read();
+        publishReading(publisher, data, REPLAY_MAC, thresholdPPM);
+
+        long t = static_cast<long>(data.timestamp - t0);
+        bool leaking = leakOnsetMs >= 0 && t >= leakOnsetMs;
+        if (publisher.closed) {
+            if (leaking && res.detectMs < 0) res.detectMs = t - leakOnsetMs;
+            if (!leaking && !wasClosed) ++res.falsePositives;
+        }
+        wasClosed = publisher.closed;
+    }
+
+    res.messages = publisher.messages;
+    res.digest   = publisher.digest;
+    return res;
+}
+
+// -------------------------
+// Comandos
+// -------------------------
+static int cmdImport(const char* logPath, const char* tracePath) {
+    std::ifstream in(logPath);
+    if (!in) {
+        fprintf(stderr, "replay: não foi possível abrir %s\n", logPath);
+        return 1;
+    }
+    std::vector<RawSample> samples;
+    std::string line;
+    while (std::getline(in, line)) {
+        RawSample s;
+        size_t tag = line.find(TRACE_LINE_TAG);  // tolera prefixos do monitor
+        if (tag != std::string::npos && parseTraceLine(line.c_str() + tag, s)) {
+            samples.push_back(s);
+        }
+    }
+    if (!saveTrace(tracePath, samples)) {
+        fprintf(stderr, "replay: falha ao gravar %s\n", tracePath);
+        return 1;
+    }
+    printf("%zu amostras gravadas em %s\n", samples.size(), tracePath);
+    return 0;
+}
+
+/// Manifesto: uma linha por trace, '#' inicia comentário.
+///   trace,threshold_ppm,leak_onset_ms,max_detect_ms,max_false_positives,messages,digest
+static int cmdBench(const char* manifestPath, int iterations) {
+    std::ifstream in(manifestPath);
+    if (!in) {
+        fprintf(stderr, "replay: não foi possível abrir %s\n", manifestPath);
+        return 1;
+    }
+    std::string dir(manifestPath);
+    size_t slash = dir.find_last_of('/');
+    dir = (slash == std::string::npos) ? "" : dir.substr(0, slash + 1);
+
+    printf("%-24s %8s %12s %10s %3s %6s %-18s %s\n", "trace", "samples",
+           "samples/s", "detect_ms", "fp", "msgs", "digest", "result");
+
+    int failures = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        char name[128];
+        float threshold;
+        long onset, maxDetect, messages;
+        int maxFp;
+        unsigned long long digest;
+        if (sscanf(line.c_str(), "%127[^,],%f,%ld,%ld,%d,%ld,%llx", name, &threshold,
+                   &onset, &maxDetect, &maxFp, &messages, &digest) != 7) {
+            fprintf(stderr, "replay: linha inválida no manifesto: %s\n", line.c_str());
+            ++failures;
+            continue;
+        }
+
+        std::vector<RawSample> samples;
+        if (!loadTrace(dir + name, samples)) {
+            fprintf(stderr, "replay: trace inválido: %s\n", name);
+            ++failures;
+            continue;
+        }
+
+        ReplayResult res = replay(samples, threshold, onset);
+        volatile uint64_t sink = 0;  // impede que o laço seja descartado
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) sink = sink + replay(samples, threshold, onset).digest;
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double rate = elapsed.count() > 0
+                      ? samples.size() * static_cast<double>(iterations) / elapsed.count()
+                      : 0.0;
+
+        bool ok = res.falsePositives <= maxFp &&
+                  res.messages == static_cast<uint32_t>(messages) &&
+                  res.digest == digest;
+        if (onset >= 0) ok = ok && res.detectMs >= 0 && res.detectMs <= maxDetect;
+        if (!ok) ++failures;
+
+        printf("%-24s %8zu %12.0f %10ld %3d %6u 0x%016llx %s\n", name, samples.size(),
+               rate, res.detectMs, res.falsePositives, res.messages,
+               static_cast<unsigned long long>(res.digest), ok ? "OK" : "FAIL");
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 4 && strcmp(argv[1], "import") == 0) {
+        return cmdImport(argv[2], argv[3]);
+    }
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "bench") == 0) {
+        int iterations = (argc == 4) ? atoi(argv[3]) : 100;
+        return cmdBench(argv[2], iterations > 0 ? iterations : 1);
+    }
+    fprintf(stderr,
+            "uso: %s import <monitor.log> <saida.trace>\n"
+            "     %s bench <manifest.csv> [iteracoes]\n",
+            argv[0], argv[0]);
+    return 2;
+}